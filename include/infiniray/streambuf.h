@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2023 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * streambuf.h - std::basic_streambuf adapter over Infinite Array
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+#pragma once
+#include <infiniray.h>
+#include <stdexcept>
+#include <streambuf>
+
+namespace infinite {
+
+/*
+ * Zero-copy stream buffer over an infinite::array of characters.
+ * The get area is the readable head of the array, the put area is its free tail.
+ * Thanks to the mirror both areas are always contiguous, so formatting and parsing
+ * run directly against the ring memory. Characters read are erased from the array,
+ * characters written are appended to it.
+ * pubsync() commits pending reads and writes and hands the array back to the owner;
+ * the areas are re-acquired on the next stream operation.
+ */
+template<typename CharT, class Traits = std::char_traits<CharT>, class Allocator = allocator<CharT>>
+class basic_streambuf : public std::basic_streambuf<CharT, Traits> {
+public:
+    using array_type = array<CharT, Allocator>;
+    using char_type = CharT;
+    using traits_type = Traits;
+    using int_type = typename Traits::int_type;
+    using size_type = typename array_type::size_type;
+    using pointer = char_type*;
+
+    struct range {
+        pointer first;
+        pointer last;
+    };
+
+    explicit basic_streambuf(array_type& array) noexcept : array_{array} {}
+    basic_streambuf(const basic_streambuf&) = delete;
+    basic_streambuf& operator=(const basic_streambuf&) = delete;
+    ~basic_streambuf() override { commit_pending(); }
+
+    // Returns free space for hand-written formatting (e.g. std::to_chars), at least n characters
+    [[nodiscard]] range prepare(size_type n = 0) {
+        if (this->pbase() == nullptr || available() < n) {
+            map_areas();
+            if (available() < n) {
+                infiniray_throw_or_abort(std::length_error("array capacity is exhausted"));
+            }
+        }
+        return { this->pptr(), this->epptr() };
+    }
+    // Appends characters formatted in [prepare().first, last) to the array
+    void commit(pointer last) {
+        if (last < this->pptr() || last > this->epptr()) {
+            infiniray_throw_or_abort(std::out_of_range("commit beyond prepared range"));
+        }
+        if (const auto produced = last - this->pbase(); produced != 0) {
+            array_.resize(array_.size() + static_cast<size_type>(produced));
+        }
+        this->setp(last, this->epptr());
+    }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (this->pptr() == this->epptr()) {
+            map_areas();
+        }
+        if (traits_type::eq_int_type(ch, traits_type::eof())) {
+            return traits_type::not_eof(ch);
+        }
+        if (this->pptr() == this->epptr()) {
+            return traits_type::eof();
+        }
+        *this->pptr() = traits_type::to_char_type(ch);
+        this->pbump(1);
+        return ch;
+    }
+    int_type underflow() override {
+        map_areas();
+        return this->gptr() == this->egptr() ? traits_type::eof() : traits_type::to_int_type(*this->gptr());
+    }
+    int sync() override {
+        commit_pending();
+        this->setg(nullptr, nullptr, nullptr);
+        this->setp(nullptr, nullptr);
+        return 0;
+    }
+
+private:
+    size_type available() const noexcept { return static_cast<size_type>(this->epptr() - this->pptr()); }
+    void commit_pending() {
+        if (const auto consumed = this->gptr() - this->eback(); consumed != 0) {
+            array_.erase(static_cast<size_type>(consumed));
+        }
+        if (const auto produced = this->pptr() - this->pbase(); produced != 0) {
+            array_.resize(array_.size() + static_cast<size_type>(produced));
+        }
+    }
+    void map_areas() {
+        commit_pending();
+        const pointer first = array_.begin();
+        const pointer last = array_.end();
+        this->setg(first, first, last);
+        this->setp(last, first + array_.capacity());
+    }
+    array_type& array_;
+};
+
+using streambuf = basic_streambuf<char>;
+
+} // namespace
@@ -9,8 +9,12 @@
 
 #include <iostream>
 #include <algorithm>
+#include <array>
 #include <vector>
+#include <charconv>
+#include <sstream>
 #include <infiniray.h>
+#include <infiniray/streambuf.h>
 #include "common.h"
 
 using namespace std;
@@ -116,11 +120,102 @@ static bool test_construct() {{
     return expect_match(test::destructed, (test::defaulted + test::valued + test::copied + test::moved));
 }
 
+static int test_streambuf() {
+    infinite::array<char> buffer(4096);
+    infinite::streambuf sbuf{buffer};
+    ostream out{&sbuf};
+    istream in{&sbuf};
+    unsigned long written {};
+    unsigned long read {};
+    while(written < buffer.capacity()) {
+        for(int i = 0; i < 64; i++) {
+            out << "line " << ++written << '\n';
+        }
+        auto [first, last] = sbuf.prepare(32);
+        auto result = std::to_chars(first, last, ++written);
+        *result.ptr++ = '\n';
+        sbuf.commit(result.ptr);
+        string word;
+        unsigned long value;
+        while(read < written - 16) {
+            if (read % 65 != 64) {
+                in >> word;
+                if (expect_match(word, "line")) return 1;
+            }
+            in >> value;
+            if (expect_match(value, ++read)) return 1;
+        }
+    }
+    sbuf.pubsync();
+    ostringstream rest;
+    for(auto i = buffer.begin(); i != buffer.end(); i++)
+        rest << *i;
+    ostringstream expected;
+    expected << '\n';
+    while(read < written) {
+        if (++read % 65 != 0)
+            expected << "line ";
+        expected << read << '\n';
+    }
+    return expect_match(rest.str(), expected.str());
+}
+
+static int test_streambuf_limits() {
+    infinite::array<char> buffer(16);
+    infinite::streambuf sbuf{buffer};
+    ostream out{&sbuf};
+    istream in{&sbuf};
+    int fail_count {};
+    bool rejected {};
+    try {
+        (void) sbuf.prepare(buffer.capacity() + 1);
+    } catch(const length_error&) {
+        rejected = true;
+    }
+    fail_count += expect(rejected);
+    rejected = false;
+    auto [first, last] = sbuf.prepare();
+    try {
+        sbuf.commit(last + 1);
+    } catch(const out_of_range&) {
+        rejected = true;
+    }
+    fail_count += expect(rejected);
+    rejected = false;
+    sbuf.commit(first + 1);
+    try {
+        sbuf.commit(first);
+    } catch(const out_of_range&) {
+        rejected = true;
+    }
+    fail_count += expect(rejected);
+    fail_count += expect_match(buffer.size(), 1UL);
+    buffer.clear();
+    sbuf.pubsync();
+    for(size_t i = 0; i <= buffer.capacity(); i++)
+        out << 'x';
+    fail_count += expect(out.bad());
+    fail_count += expect_match(buffer.size(), buffer.capacity());
+    string word;
+    in >> word;
+    fail_count += expect_match(word, string(buffer.capacity(), 'x'));
+    fail_count += expect(in.eof());
+    fail_count += expect(buffer.empty());
+    in.clear();
+    out.clear();
+    out << "more" << flush;
+    in >> word;
+    fail_count += expect_match(word, "more");
+    return fail_count;
+}
+
 int main() {
 	int fail_count =
 	test_mirror() +
 	test_construct() +
 	test_process() +
+	test_streambuf() +
+	test_streambuf_limits() +
 	test_nointerfere();
 	// TODO test struct with odd alignment
 	return fail_count;